@@ -0,0 +1,324 @@
+#!/usr/bin/env python3
+#
+# Compile-time benchmarks for list.hpp
+#
+# Every case generates one translation unit per size and compiles it with
+# -fsyntax-only, recording the wall time and the peak RSS of the compiler.
+# Template instantiation figures come from -ftime-trace when the compiler
+# supports it (clang: number of instantiations) and from -ftime-report
+# otherwise (gcc: time and memory spent in template instantiation). Each
+# unit is also compiled with a small -ftemplate-depth to show whether the
+# algorithm's nesting depth grows with the input.
+#
+# The results are printed as a table and optionally written as CSV or JSON,
+# the format follows the extension of the --output file.
+#
+
+import argparse
+import csv
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SIZES = [10, 100, 1000, 10000]
+SHALLOW_DEPTH = 64
+TIMEOUT = 600
+
+
+def int_list(n):
+    return "ML::list<{}>".format(", ".join("ML::int_t<{}>".format(i) for i in range(n)))
+
+
+def case_get(n):
+    return (
+        "using L = {};\n"
+        "static_assert(std::is_same<ML::get_t<L, {}>, ML::int_t<{}>>::value, \"\");\n"
+        "static_assert(std::is_same<ML::get_t<L, {}>, ML::int_t<{}>>::value, \"\");\n"
+    ).format(int_list(n), n - 1, n - 1, n // 2, n // 2)
+
+
+def case_range(n):
+    return "static_assert(ML::length_v<ML::range_t<int, 0, {}>> == {}, \"\");\n".format(n - 1, n)
+
+
+def case_table(n):
+    return (
+        "template<int i> using square = ML::int_t<i * i>;\n"
+        "static_assert(ML::length_v<ML::table_t<square, ML::int_range<{}, 0, -1>>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::array_t<square, {}>> == {}, \"\");\n"
+    ).format(n - 1, n, n, n)
+
+
+def case_select(n):
+    return (
+        "template<typename T> using odd = ML::bool_t<T::value % 2 == 1>;\n"
+        "static_assert(ML::length_v<ML::select_t<ML::range_t<int, 0, {}>, odd>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::select_t<{}, odd>> == {}, \"\");\n"
+    ).format(n - 1, n // 2, int_list(n), n // 2)
+
+
+def case_join(n):
+    return (
+        "template<typename S> struct pieces;\n"
+        "template<ML::length_t... is> struct pieces<std::integer_sequence<ML::length_t, is...>>\n"
+        "{{\n"
+        "    using type = typename ML::join<ML::list<>, ML::list<ML::index_t<is>, int>...>::type;\n"
+        "    using mixed = typename ML::join<ML::index_list<is>..., ML::list<ML::index_t<is>>...>::type;\n"
+        "}};\n"
+        "using P = pieces<std::make_integer_sequence<ML::length_t, {}>>;\n"
+        "static_assert(ML::length_v<P::type> == {}, \"\");\n"
+        "static_assert(ML::length_v<P::mixed> == {}, \"\");\n"
+    ).format(n, 2 * n, 2 * n)
+
+
+def case_find(n):
+    return (
+        "using L = {};\n"
+        "using C = ML::range_t<int, 0, {}>;\n"
+        "static_assert(ML::find_v<L, ML::int_t<{}>> == {}, \"\");\n"
+        "static_assert(ML::find_with_fail_v<C, ML::int_t<-1>> == static_cast<ML::length_t>(-1), \"\");\n"
+        "static_assert(ML::count_v<C, ML::int_t<0>> == 1, \"\");\n"
+        "static_assert(!ML::member_v<L, int>, \"\");\n"
+    ).format(int_list(n), n - 1, n - 1, n - 1)
+
+
+def case_sort(n):
+    return (
+        "template<typename T> using negate = ML::int_t<-T::value>;\n"
+        "using C = ML::range_t<int, 0, {}>;\n"
+        "static_assert(ML::get_t<ML::sort_t<C, ML::greater>, 0>::value == {}, \"\");\n"
+        "static_assert(ML::get_t<ML::stable_sort_t<C, ML::greater>, 0>::value == {}, \"\");\n"
+        "static_assert(ML::get_t<ML::sort_by_t<C, negate>, 0>::value == {}, \"\");\n"
+    ).format(n - 1, n - 1, n - 1, n - 1)
+
+
+def case_edit(n):
+    return (
+        "using L = {};\n"
+        "using C = ML::range_t<int, 0, {}>;\n"
+        "static_assert(ML::length_v<ML::take_t<L, {}>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::drop_t<L, {}>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::erase_t<L, {}>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::insert_t<C, {}, ML::int_t<-1>>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::set_t<C, {}, ML::int_t<-1>>> == {}, \"\");\n"
+    ).format(int_list(n), n - 1, n // 2, n // 2, n // 2, n - n // 2, n // 2, n - 1, n // 2, n + 1, n - 1, n)
+
+
+def case_unique(n):
+    return (
+        "static_assert(ML::length_v<ML::unique_t<ML::list_c<int, {}>>> == {}, \"\");\n"
+    ).format(", ".join(str(i // 2) for i in range(n)), (n + 1) // 2)
+
+
+def case_flatten(n):
+    return (
+        "using L = ML::list<{}>;\n"
+        "static_assert(ML::length_v<ML::flatten_t<L>> == {}, \"\");\n"
+    ).format(", ".join("ML::list<ML::int_t<{}>, ML::list<int>>".format(i) for i in range(n)), 2 * n)
+
+
+def case_map(n):
+    return (
+        "template<typename T> using ptr = T*;\n"
+        "using L = {};\n"
+        "static_assert(ML::length_v<ML::map_t<ptr, L>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::map_t<ptr, ML::range_t<int, 0, {}>>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::apply_t<ML::list, L>> == {}, \"\");\n"
+    ).format(int_list(n), n, n - 1, n, n)
+
+
+def case_thread(n):
+    return (
+        "using L = {};\n"
+        "static_assert(ML::length_v<ML::thread_t<ML::list, L, L>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::extract_t<L, ML::range_t<ML::length_t, 0, {}, 2>>> == {}, \"\");\n"
+    ).format(int_list(n), n, n - 1, (n + 1) // 2)
+
+
+def case_fold(n):
+    return (
+        "template<typename A, typename B> using first = A;\n"
+        "template<typename A, typename B> using second = B;\n"
+        "using L = {};\n"
+        "using C = ML::range_t<int, 0, {}>;\n"
+        "static_assert(std::is_same<ML::fold_t<second, void, L>, ML::int_t<{}>>::value, \"\");\n"
+        "static_assert(std::is_same<ML::fold_right_t<first, void, L>, ML::int_t<0>>::value, \"\");\n"
+        "static_assert(ML::sum_v<C> == {} && ML::maximum_v<C> == {}, \"\");\n"
+    ).format(int_list(n), n - 1, n - 1, n * (n - 1) // 2, n - 1)
+
+
+def case_difference(n):
+    return (
+        "template<typename A, typename B> using minus = ML::int_t<A::value - B::value>;\n"
+        "static_assert(ML::length_v<ML::difference<minus, ML::range_t<int, 0, {}>>::type> == {}, \"\");\n"
+    ).format(n - 1, n)
+
+
+def case_replace(n):
+    return (
+        "using L = {};\n"
+        "using C = ML::range_t<int, 0, {}>;\n"
+        "static_assert(ML::length_v<ML::replace_t<L, ML::int_t<{}>, int>> == {}, \"\");\n"
+        "static_assert(ML::length_v<ML::replace_all_t<C, ML::int_t<0>, ML::int_t<1>>> == {}, \"\");\n"
+    ).format(int_list(n), n - 1, n - 1, n, n)
+
+
+def case_contains(n):
+    return (
+        "template<typename T> using small = ML::bool_t<(T::value < {})>;\n"
+        "using L = {};\n"
+        "using R = ML::range_t<int, {}, 0, -1>;\n"
+        "static_assert(ML::all_true_v<L, small>, \"\");\n"
+        "static_assert(ML::contains_all_v<L, R>, \"\");\n"
+        "static_assert(ML::contains_any_v<L, ML::list<ML::int_t<{}>>>, \"\");\n"
+        "static_assert(ML::contains_none_v<L, ML::list<int, char>>, \"\");\n"
+        "static_assert(ML::contains_exactly_v<L, R>, \"\");\n"
+    ).format(n, int_list(n), n - 1, n - 1)
+
+
+CASES = {
+    "get": case_get,
+    "range": case_range,
+    "table": case_table,
+    "select": case_select,
+    "join": case_join,
+    "find": case_find,
+    "sort": case_sort,
+    "edit": case_edit,
+    "unique": case_unique,
+    "flatten": case_flatten,
+    "map": case_map,
+    "thread": case_thread,
+    "fold": case_fold,
+    "difference": case_difference,
+    "replace": case_replace,
+    "contains": case_contains,
+}
+
+
+def source(case, n):
+    return "#include <type_traits>\n#include \"list.hpp\"\n\n" + CASES[case](n)
+
+
+def run(cmd, timeout):
+    """Run a compiler command, return its status, wall time, peak RSS (KiB) and stderr"""
+    start = time.perf_counter()
+    with tempfile.TemporaryFile() as err:
+        proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=err)
+        status = "ok"
+        while True:
+            pid, code, usage = os.wait4(proc.pid, os.WNOHANG)
+            if pid:
+                break
+            if time.perf_counter() - start > timeout:
+                proc.kill()
+                pid, code, usage = os.wait4(proc.pid, 0)
+                status = "timeout"
+                break
+            time.sleep(0.01)
+        seconds = time.perf_counter() - start
+        proc.returncode = code  # already reaped by wait4
+        err.seek(0)
+        stderr = err.read().decode(errors="replace")
+    if status == "ok" and code != 0:
+        status = "failed"
+    return status, seconds, usage.ru_maxrss, stderr
+
+
+def supports_time_trace(compiler):
+    with tempfile.TemporaryDirectory() as tmp:
+        cmd = [compiler, "-x", "c++", "-fsyntax-only", "-ftime-trace=" + os.path.join(tmp, "probe.json"), os.devnull]
+        return subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL).returncode == 0
+
+
+TIME_REPORT = re.compile(r"^\s*template instantiation\s*:" + r"\s*([\d.]+)\s*\(\s*\d+%\)" * 3 + r"\s*([\d.]+[kMG]?)",
+                         re.MULTILINE)
+
+
+def instantiation_stats(stderr, trace):
+    """Parse -ftime-trace output if there is one, -ftime-report output otherwise"""
+    stats = {"instantiations": "", "instantiation_seconds": "", "instantiation_memory": ""}
+    if trace:
+        if os.path.exists(trace):
+            with open(trace) as f:
+                events = json.load(f).get("traceEvents", [])
+            names = ("InstantiateClass", "InstantiateFunction")
+            stats["instantiations"] = sum(1 for e in events if e.get("name") in names)
+            stats["instantiation_seconds"] = round(sum(e.get("dur", 0) for e in events
+                                                       if e.get("name") == "Total InstantiateClass") / 1e6, 3)
+    else:
+        match = TIME_REPORT.search(stderr)
+        if match:
+            stats["instantiation_seconds"] = float(match.group(3))
+            stats["instantiation_memory"] = match.group(4)
+    return stats
+
+
+def bench(compiler, case, n, tmp, trace, timeout):
+    path = os.path.join(tmp, "{}_{}.cpp".format(case, n))
+    with open(path, "w") as f:
+        f.write(source(case, n))
+    cmd = [compiler, "-std=c++17", "-fsyntax-only", "-I", ROOT]
+    json_path = path[:-len(".cpp")] + ".json" if trace else None
+    extra = ["-ftime-trace=" + json_path, "-ftime-trace-granularity=0"] if trace else ["-ftime-report"]
+    status, seconds, rss, stderr = run(cmd + extra + [path], timeout)
+    row = {"case": case, "size": n, "status": status, "seconds": round(seconds, 3), "peak_rss_kib": rss}
+    row.update(instantiation_stats(stderr, json_path if status == "ok" else None) if status == "ok"
+               else {"instantiations": "", "instantiation_seconds": "", "instantiation_memory": ""})
+    shallow = ""
+    if status == "ok":
+        shallow = run(cmd + ["-ftemplate-depth={}".format(SHALLOW_DEPTH), path], timeout)[0]
+        shallow = "ok" if shallow == "ok" else "exceeded"
+    row["depth{}".format(SHALLOW_DEPTH)] = shallow
+    return row
+
+
+def write_report(path, compiler, rows):
+    with open(path, "w", newline="") as f:
+        if path.endswith(".json"):
+            json.dump({"compiler": compiler, "results": rows}, f, indent=2)
+            f.write("\n")
+        else:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0]) if rows else [])
+            writer.writeheader()
+            writer.writerows(rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compile-time benchmarks for list.hpp")
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--sizes", type=int, nargs="+", default=SIZES)
+    parser.add_argument("--timeout", type=float, default=TIMEOUT, help="seconds allowed per translation unit")
+    parser.add_argument("--output", action="append", default=[], help="write a report, .csv or .json")
+    parser.add_argument("cases", nargs="*", default=list(CASES))
+    args = parser.parse_args()
+    unknown = [case for case in args.cases if case not in CASES]
+    if unknown:
+        parser.error("unknown cases: " + ", ".join(unknown) + " (choose from " + ", ".join(CASES) + ")")
+
+    trace = supports_time_trace(args.compiler)
+    depth = "depth{}".format(SHALLOW_DEPTH)
+    line = "{:<10} {:>6} {:>8} {:>9} {:>10} {:>8} {:>9}"
+    print(line.format("case", "size", "status", "time(s)", "rss(KiB)", "inst" if trace else "inst(s)", depth))
+    rows = []
+    with tempfile.TemporaryDirectory() as tmp:
+        for case in args.cases:
+            for n in args.sizes:
+                row = bench(args.compiler, case, n, tmp, trace, args.timeout)
+                rows.append(row)
+                print(line.format(case, n, row["status"], row["seconds"], row["peak_rss_kib"],
+                                  row["instantiations" if trace else "instantiation_seconds"], row[depth]),
+                      flush=True)
+    for path in args.output:
+        write_report(path, args.compiler, rows)
+    return 0 if all(row["status"] == "ok" for row in rows) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -5,6 +5,22 @@
 #ifndef MLIST_LIST_HPP
 #define MLIST_LIST_HPP
 
+#include <array>
+#include <type_traits>
+#include <utility>
+
+// __type_pack_element: compiler builtin for O(1) pack indexing (clang)
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define MLIST_HAS_TYPE_PACK_ELEMENT
+#endif
+#endif
+
+// MLIST_INDEXED_JOIN: join lists by indexing the pack, the default only when indexing is O(1)
+#if defined(MLIST_HAS_TYPE_PACK_ELEMENT) && !defined(MLIST_INDEXED_JOIN)
+#define MLIST_INDEXED_JOIN
+#endif
+
 namespace ML
 {
     // Length type
@@ -64,6 +80,495 @@ namespace ML
         template<char... cs> constexpr char_list<cs...> operator ""_cl () {return {};}
     } // namespace literal
 
+    // less, greater: comparators for sort, any constexpr default constructible function object works
+    struct less
+    {
+        template<typename T>
+        constexpr bool operator()(const T& a, const T& b) const {return a < b;}
+    };
+    struct greater
+    {
+        template<typename T>
+        constexpr bool operator()(const T& a, const T& b) const {return b < a;}
+    };
+
+    namespace detail
+    {
+        // make_index_seq: sequence of length_t in [0, n)
+        template<length_t n>
+        using make_index_seq = std::make_integer_sequence<length_t, n>;
+
+        // values: constexpr storage of a value pack
+        template<typename T, T... vs>
+        struct values
+        {
+            static constexpr std::array<T, sizeof...(vs)> value{{vs...}};
+        };
+
+        // type_at: get the nth type of a pack without recursion
+#ifdef MLIST_HAS_TYPE_PACK_ELEMENT
+        template<length_t n, typename... Ts>
+        using type_at_t = __type_pack_element<n, Ts...>;
+#else
+        // indexer inherits one tagged base per element, overload resolution picks the nth
+        template<length_t n, typename T>
+        struct indexed
+        {
+            using type = T;
+        };
+        template<typename S, typename... Ts> struct indexer;
+        template<length_t... is, typename... Ts>
+        struct indexer<std::integer_sequence<length_t, is...>, Ts...> : indexed<is, Ts>...
+        {};
+        template<length_t n, typename T>
+        indexed<n, T> index_lookup(const indexed<n, T>*);
+
+        template<length_t n, typename... Ts>
+        using type_at_t = typename decltype(index_lookup<n>(
+            static_cast<indexer<make_index_seq<sizeof...(Ts)>, Ts...>*>(nullptr)))::type;
+#endif
+
+        // drop_front: the first n arguments bind to const void*, the rest are deduced
+        template<typename T> struct tag {};
+        template<length_t> struct ignore
+        {
+            using type = const void*;
+        };
+        template<typename S> struct dropper;
+        template<length_t... is>
+        struct dropper<std::integer_sequence<length_t, is...>>
+        {
+            template<typename... Ts>
+            static list<Ts...> eval(typename ignore<is>::type..., tag<Ts>*...);
+        };
+        template<length_t n, typename... Ts>
+        using drop_front_t = decltype(dropper<make_index_seq<n>>::eval(static_cast<tag<Ts>*>(nullptr)...));
+
+        // range_size: the number of items in [l, r] stepped by d, d may be negative
+        template<typename T>
+        constexpr length_t range_size(T l, T r, T d)
+        {
+            if (d > 0) return l <= r ? static_cast<length_t>((r - l) / d) + 1 : 0;
+            return l >= r ? static_cast<length_t>((l - r) / -d) + 1 : 0;
+        }
+
+        // range_at: the ith item of a range starting at l stepped by d
+        template<typename T>
+        constexpr T range_at(T l, T d, length_t i)
+        {
+            return static_cast<T>(l + static_cast<T>(i) * d);
+        }
+
+        // index_of: the index of the first item equal to v, n if there is none
+        template<typename T, std::size_t n>
+        constexpr length_t index_of(const std::array<T, n>& a, const T& v)
+        {
+            for (length_t i = 0; i < n; ++i)
+                if (a[i] == v) return i;
+            return n;
+        }
+
+        // count_of: the number of items equal to v
+        template<typename T, std::size_t n>
+        constexpr length_t count_of(const std::array<T, n>& a, const T& v)
+        {
+            length_t c = 0;
+            for (length_t i = 0; i < n; ++i)
+                if (a[i] == v) ++c;
+            return c;
+        }
+
+        // array_list_c: expand the static constexpr array A::value into a list_c
+        template<typename T, typename A, typename S = make_index_seq<A::value.size()>> struct array_list_c;
+        template<typename T, typename A, length_t... is>
+        struct array_list_c<T, A, std::integer_sequence<length_t, is...>>
+        {
+            using type = list_c<T, A::value[is]...>;
+        };
+
+        // heap_sort: sort a copy of the array, not stable
+        template<typename T, std::size_t n, typename C>
+        constexpr std::array<T, n> heap_sort(std::array<T, n> a, C c)
+        {
+            // sift a[i] down the heap a[0, m)
+            auto sift = [&a, &c](length_t i, length_t m)
+            {
+                for (length_t j = 2 * i + 1; j < m; i = j, j = 2 * i + 1)
+                {
+                    if (j + 1 < m && c(a[j], a[j + 1])) ++j;
+                    if (!c(a[i], a[j])) break;
+                    T t = a[i]; a[i] = a[j]; a[j] = t;
+                }
+            };
+            for (length_t i = n / 2; i > 0; --i) sift(i - 1, n);
+            for (length_t m = n; m > 1; --m)
+            {
+                T t = a[0]; a[0] = a[m - 1]; a[m - 1] = t;
+                sift(0, m - 1);
+            }
+            return a;
+        }
+
+        // merge_sort: sort a copy of the array, stable
+        template<typename T, std::size_t n, typename C>
+        constexpr std::array<T, n> merge_sort(std::array<T, n> a, C c)
+        {
+            std::array<T, n> b{};
+            for (length_t w = 1; w < n; w *= 2)
+            {
+                for (length_t l = 0; l < n; l += 2 * w)
+                {
+                    length_t m = l + w < n ? l + w : n, r = l + 2 * w < n ? l + 2 * w : n;
+                    length_t i = l, j = m, k = l;
+                    while (i < m && j < r) b[k++] = c(a[j], a[i]) ? a[j++] : a[i++];
+                    while (i < m) b[k++] = a[i++];
+                    while (j < r) b[k++] = a[j++];
+                }
+                for (length_t i = 0; i < n; ++i) a[i] = b[i];
+            }
+            return a;
+        }
+
+        // sort_order: stable sort the indices of the array by their key
+        template<typename K, std::size_t n, typename C>
+        constexpr std::array<length_t, n> sort_order(const std::array<K, n>& keys, C c)
+        {
+            struct entry
+            {
+                K key;
+                length_t index;
+            };
+            std::array<entry, n> a{};
+            for (length_t i = 0; i < n; ++i) a[i] = entry{keys[i], i};
+            a = merge_sort(a, [&c](const entry& x, const entry& y) {return c(x.key, y.key);});
+            std::array<length_t, n> result{};
+            for (length_t i = 0; i < n; ++i) result[i] = a[i].index;
+            return result;
+        }
+
+        // permute: the array with a[order[i]] at position i
+        template<typename T, std::size_t n>
+        constexpr std::array<T, n> permute(const std::array<T, n>& a, const std::array<length_t, n>& order)
+        {
+            std::array<T, n> result{};
+            for (length_t i = 0; i < n; ++i) result[i] = a[order[i]];
+            return result;
+        }
+
+        // run_starts: whether each item differs from the one before it
+        template<typename T, std::size_t n>
+        constexpr std::array<bool, n> run_starts(const std::array<T, n>& a)
+        {
+            std::array<bool, n> keep{};
+            for (length_t i = 0; i < n; ++i) keep[i] = i == 0 || !(a[i] == a[i - 1]);
+            return keep;
+        }
+
+        // first_occurrences: whether each item is the first one equal to it, by a stable sort
+        template<typename T, std::size_t n>
+        constexpr std::array<bool, n> first_occurrences(const std::array<T, n>& a)
+        {
+            const std::array<length_t, n> order = sort_order(a, less{});
+            std::array<bool, n> keep{};
+            for (length_t i = 0; i < n; ++i) keep[order[i]] = i == 0 || !(a[order[i]] == a[order[i - 1]]);
+            return keep;
+        }
+
+        // compact: the m items whose keep flag is set, in order
+        template<length_t m, typename T, std::size_t n>
+        constexpr std::array<T, m> compact(const std::array<T, n>& a, const std::array<bool, n>& keep)
+        {
+            std::array<T, m> result{};
+            for (length_t i = 0, j = 0; i < n; ++i)
+                if (keep[i]) result[j++] = a[i];
+            return result;
+        }
+
+        // kept_values: the values of a list_c whose flag in K::value is set, as a list_c
+        template<typename K, typename T, T... vs>
+        struct kept_values
+        {
+        private:
+            // Helper
+            struct kept
+            {
+                static constexpr auto value = compact<count_of(K::value, true)>(values<T, vs...>::value, K::value);
+            };
+
+        public:
+            using type = typename array_list_c<T, kept>::type;
+        };
+
+        // matches: whether each item of a type list is T
+        template<typename T, typename... Ts>
+        struct matches
+        {
+            static constexpr std::array<bool, sizeof...(Ts)> value{{std::is_same_v<T, Ts>...}};
+        };
+
+        // list_c_kind: whether L is a list_c, empty is the empty list of the same kind
+        template<typename L>
+        struct list_c_kind : public std::false_type
+        {
+            using empty = list<>;
+        };
+        template<typename T, T... vs>
+        struct list_c_kind<list_c<T, vs...>> : public std::true_type
+        {
+            using empty = list_c<T>;
+        };
+
+        // as_list: convert a list_c to a list of wrapper_t
+        template<typename L>
+        struct as_list
+        {
+            using type = L;
+        };
+        template<typename T, T... vs>
+        struct as_list<list_c<T, vs...>>
+        {
+            using type = list<wrapper_t<T, vs>...>;
+        };
+
+        // as_list_c: convert a list of wrapper_t back to list_c, E is the empty list_c
+        template<typename E, typename L> struct as_list_c;
+        template<typename T, T... vs>
+        struct as_list_c<list_c<T>, list<wrapper_t<T, vs>...>>
+        {
+            using type = list_c<T, vs...>;
+        };
+
+        // joinable: whether L can be joined into a list whose empty list is E
+        template<typename E, typename L>
+        struct joinable : public std::false_type
+        {};
+        template<typename... Ts>
+        struct joinable<list<>, list<Ts...>> : public std::true_type
+        {};
+        template<typename T, T... vs>
+        struct joinable<list_c<T>, list_c<T, vs...>> : public std::true_type
+        {};
+        template<typename T, T... vs>
+        struct joinable<list_c<T>, list<wrapper_t<T, vs>...>> : public std::true_type
+        {};
+        template<typename E, typename... Ls>
+        struct all_joinable
+        {
+            static constexpr bool value = index_of(std::array<bool, sizeof...(Ls)>{
+                {joinable<E, Ls>::value...}}, false) == sizeof...(Ls);
+        };
+
+        // join8: concat 8 lists at once
+        template<typename L0, typename L1, typename L2, typename L3,
+            typename L4, typename L5, typename L6, typename L7> struct join8;
+        template<typename... T0s, typename... T1s, typename... T2s, typename... T3s,
+            typename... T4s, typename... T5s, typename... T6s, typename... T7s>
+        struct join8<list<T0s...>, list<T1s...>, list<T2s...>, list<T3s...>,
+            list<T4s...>, list<T5s...>, list<T6s...>, list<T7s...>>
+        {
+            using type = list<T0s..., T1s..., T2s..., T3s..., T4s..., T5s..., T6s..., T7s...>;
+        };
+        template<typename T, T... v0s, T... v1s, T... v2s, T... v3s, T... v4s, T... v5s, T... v6s, T... v7s>
+        struct join8<list_c<T, v0s...>, list_c<T, v1s...>, list_c<T, v2s...>, list_c<T, v3s...>,
+            list_c<T, v4s...>, list_c<T, v5s...>, list_c<T, v6s...>, list_c<T, v7s...>>
+        {
+            using type = list_c<T, v0s..., v1s..., v2s..., v3s..., v4s..., v5s..., v6s..., v7s...>;
+        };
+
+        // join_small: join up to 8 lists, E is the empty list used as padding
+        template<typename E, typename L0 = E, typename L1 = E, typename L2 = E, typename L3 = E,
+            typename L4 = E, typename L5 = E, typename L6 = E, typename L7 = E>
+        struct join_small : public join8<L0, L1, L2, L3, L4, L5, L6, L7>
+        {};
+
+        // box: names T by a class local to box_key<T>, a local class is not a template
+        // specialization, so argument dependent lookup on a class holding a box does
+        // not walk the template arguments of T
+        template<typename T>
+        constexpr auto box_key()
+        {
+            struct key
+            {
+                using type [[maybe_unused]] = T;
+            };
+            return key{};
+        }
+        template<typename T>
+        using box = decltype(box_key<T>());
+
+        // join_tree: join lists of the same kind with logarithmic depth
+        template<typename E, typename... Ls> struct join_tree;
+#ifdef MLIST_INDEXED_JOIN
+        // With O(1) pack indexing the lists are joined 8 at a time, level by level
+        template<typename E, typename... Ls>
+        struct join_tree
+        {
+        private:
+            // Helpers
+            template<length_t i>
+            using at = type_at_t<i, Ls..., E, E, E, E, E, E, E>;
+            template<typename S> struct helper;
+            template<length_t... is>
+            struct helper<std::integer_sequence<length_t, is...>>
+            {
+                using type = typename join_tree<E, typename join8<at<is * 8>, at<is * 8 + 1>,
+                    at<is * 8 + 2>, at<is * 8 + 3>, at<is * 8 + 4>, at<is * 8 + 5>,
+                    at<is * 8 + 6>, at<is * 8 + 7>>::type...>::type;
+            };
+
+        public:
+            using type = typename helper<make_index_seq<(sizeof...(Ls) + 7) / 8>>::type;
+        };
+#else
+        // Without it, indexing a pack costs O(n), so the lists are pushed one by one
+        // onto a binary counter of runs (a run of rank r joins 2^r lists) by a fold
+        // expression. Every item is copied O(log n) times and the depth is O(log n).
+        // Runs name their list by a box, so argument dependent lookup of operator+
+        // does not walk the items of every run on the stack.
+        template<length_t r, typename K> struct run {};
+        template<typename E, typename... Rs> struct run_stack {};
+        template<typename K> struct run_item {};
+
+        // run_merge: merge the two topmost runs while they have the same rank
+        template<typename S> struct run_merge
+        {
+            using type = S;
+        };
+        template<typename E, length_t r, typename K1, typename K2, typename... Rs>
+        struct run_merge<run_stack<E, run<r, K1>, run<r, K2>, Rs...>>
+        {
+            using type = typename run_merge<run_stack<E, run<r + 1, box<
+                typename join_small<E, typename K2::type, typename K1::type>::type>>, Rs...>>::type;
+        };
+        template<typename E, typename... Rs, typename K>
+        typename run_merge<run_stack<E, run<0, K>, Rs...>>::type operator+(
+            const run_stack<E, Rs...>&, const run_item<K>&);
+
+        // run_collapse: join the remaining runs, the topmost run is the last one
+        template<typename S> struct run_collapse;
+        template<typename E>
+        struct run_collapse<run_stack<E>>
+        {
+            using type = E;
+        };
+        template<typename E, length_t r, typename K, typename... Rs>
+        struct run_collapse<run_stack<E, run<r, K>, Rs...>>
+        {
+            using type = typename join_small<E, typename run_collapse<run_stack<E, Rs...>>::type,
+                typename K::type>::type;
+        };
+
+        template<typename E, typename... Ls>
+        struct join_tree
+        {
+            using type = typename run_collapse<decltype((run_stack<E>{} + ... +
+                run_item<box<Ls>>{}))>::type;
+        };
+#endif
+        template<typename E>
+        struct join_tree<E>
+        {
+            using type = E;
+        };
+        template<typename E, typename L>
+        struct join_tree<E, L>
+        {
+            using type = L;
+        };
+
+        // pair_end: pads a list shifted by one, so that items can be paired with the next one
+        struct pair_end {};
+
+        // unique_pairs: the items of list<Qs...> not the same as the item before them, list<Ps...>
+        template<typename L1, typename L2> struct unique_pairs;
+        template<typename... Ps, typename... Qs>
+        struct unique_pairs<list<Ps...>, list<Qs...>>
+        {
+            using type = typename join_tree<list<>, std::conditional_t<std::is_same_v<Ps, Qs> ||
+                std::is_same_v<Qs, pair_end>, list<>, list<Qs>>...>::type;
+        };
+
+        // type_set: inherits tag<T> for every item of a list without duplicates,
+        // so membership is one is_base_of check
+        template<typename L> struct type_set;
+        template<typename... Ts>
+        struct type_set<list<Ts...>> : public tag<Ts>...
+        {};
+
+        // select_new: the items of a list that are not in the type_set S
+        template<typename S, typename L> struct select_new;
+        template<typename S, typename... Ts>
+        struct select_new<S, list<Ts...>>
+        {
+            using type = typename join_tree<list<>,
+                std::conditional_t<std::is_base_of_v<tag<Ts>, S>, list<>, list<Ts>>...>::type;
+        };
+
+        // fold_left_acc, fold_right_acc: the result of a fold so far, a fold expression over
+        // operator+ applies F once per item, without recursion, and the result stays boxed
+        template<template<typename, typename> typename F, typename K>
+        struct fold_left_acc
+        {
+            using type = typename K::type;
+        };
+        template<template<typename, typename> typename F, typename K>
+        struct fold_right_acc
+        {
+            using type = typename K::type;
+        };
+        template<typename T> struct fold_item {};
+        template<template<typename, typename> typename F, typename K, typename T>
+        fold_left_acc<F, box<F<typename K::type, T>>> operator+(const fold_left_acc<F, K>&, const fold_item<T>&);
+        template<template<typename, typename> typename F, typename T, typename K>
+        fold_right_acc<F, box<F<T, typename K::type>>> operator+(const fold_item<T>&, const fold_right_acc<F, K>&);
+
+        // min_acc, max_acc: the least and the greatest value of a fold expression over operator|
+        template<typename T>
+        struct min_acc
+        {
+            T value;
+        };
+        template<typename T>
+        struct max_acc
+        {
+            T value;
+        };
+        template<typename T>
+        constexpr min_acc<T> operator|(const min_acc<T>& a, const min_acc<T>& b)
+        {
+            return b.value < a.value ? b : a;
+        }
+        template<typename T>
+        constexpr max_acc<T> operator|(const max_acc<T>& a, const max_acc<T>& b)
+        {
+            return a.value < b.value ? b : a;
+        }
+
+        // value_fold: left-fold the values of a list_c with a function object, through a fold
+        // expression over operator<< (GCC evaluates a long comma fold much slower)
+        template<typename S, typename Fn>
+        struct value_acc
+        {
+            S value;
+            Fn& f;
+        };
+        template<typename S, typename Fn, typename T>
+        constexpr value_acc<S, Fn> operator<<(const value_acc<S, Fn>& a, const T& v)
+        {
+            return {a.f(a.value, v), a.f};
+        }
+        template<typename L> struct value_fold;
+        template<typename T, T... vs>
+        struct value_fold<list_c<T, vs...>>
+        {
+            template<typename S, typename Fn>
+            static constexpr S apply(const S& init, Fn& f)
+            {
+                return (value_acc<S, Fn>{init, f} << ... << vs).value;
+            }
+        };
+    } // namespace detail
+
     // conditional: select from two values
     template<typename B, typename T, typename F> struct conditional;
     template<typename T, typename F>
@@ -80,7 +585,7 @@ namespace ML
     using conditional_t = typename conditional<B, T, F>::type;
 
     // Algorithms
-    // concat: concat two lists
+    // concat: concat two lists, a list of wrapper_t can be concatenated with a list_c
     template<typename L1, typename L2> struct concat;
     template<typename... T1s, typename... T2s>
     struct concat<list<T1s...>, list<T2s...>>
@@ -92,20 +597,45 @@ namespace ML
     {
         using type = list_c<T, v1s..., v2s...>;
     };
+    template<typename T, T... v1s, T... v2s>
+    struct concat<list_c<T, v1s...>, list<wrapper_t<T, v2s>...>>
+    {
+        using type = list_c<T, v1s..., v2s...>;
+    };
+    template<typename T, T... v1s, T... v2s>
+    struct concat<list<wrapper_t<T, v1s>...>, list_c<T, v2s...>>
+    {
+        using type = list_c<T, v1s..., v2s...>;
+    };
     template<typename L1, typename L2>
     using concat_t = typename concat<L1, L2>::type;
 
-    // join: join n lists
-    template<typename L1, typename... Ls> struct join;
-    template<typename L1>
-    struct join<L1>
-    {
-        using type = L1;
-    };
-    template<typename L1, typename L2, typename... Ls>
-    struct join<L1, L2, Ls...>
+    // join: join n lists, list and list_c may be mixed when the list items are wrapper_t of the same type
+    template<typename L1, typename... Ls>
+    struct join
     {
-        using type = typename join<concat_t<L1, L2>, Ls...>::type;
+    private:
+        // The first list_c decides the value type, empty is list<> if there is none
+        static constexpr length_t size = sizeof...(Ls) + 1;
+        static constexpr length_t index = detail::index_of(std::array<bool, size>{
+            {detail::list_c_kind<L1>::value, detail::list_c_kind<Ls>::value...}}, true);
+        using first = detail::list_c_kind<detail::type_at_t<index, L1, Ls..., list<>>>;
+        using empty = typename first::empty;
+        static constexpr bool all_c = detail::index_of(std::array<bool, size>{
+            {detail::list_c_kind<L1>::value, detail::list_c_kind<Ls>::value...}}, false) == size;
+        static_assert(detail::all_joinable<empty, L1, Ls...>::value,
+            "join: all list_c must have the same value type, and so must the wrapper_t items joined with them");
+
+        // Helper
+        struct mixed
+        {
+            using type = typename detail::as_list_c<empty, typename detail::join_tree<list<>,
+                typename detail::as_list<L1>::type, typename detail::as_list<Ls>::type...>::type>::type;
+        };
+
+    public:
+        using type = typename std::conditional_t<first::value && !all_c,
+            mixed, detail::join_tree<empty, L1, Ls...>>::type;
     };
     template<typename L1, typename... Ls>
     using join_t = typename join<L1, Ls...>::type;
@@ -127,161 +657,160 @@ namespace ML
 
     // get: get the nth item of a list
     template<typename L, length_t n> struct get;
-    template<typename T1, typename... Ts>
-    struct get<list<T1, Ts...>, 0>
+    template<typename... Ts, length_t n>
+    struct get<list<Ts...>, n>
     {
-        using type = T1;
+        static_assert(n < sizeof...(Ts), "get: index out of range");
+        using type = detail::type_at_t<n, Ts...>;
     };
-    template<typename T1, typename... Ts, length_t n>
-    struct get<list<T1, Ts...>, n>
+    template<typename T, T... vs, length_t n>
+    struct get<list_c<T, vs...>, n>
     {
-        using type = typename get<list<Ts...>, n - 1>::type;
+        static_assert(n < sizeof...(vs), "get: index out of range");
+        using type = wrapper_t<T, detail::values<T, vs...>::value[n]>;
     };
-    template<typename T, T v1, T... vs>
-    struct get<list_c<T, v1, vs...>, 0>
+    template<typename L, length_t n>
+    using get_t = typename get<L, n>::type;
+
+    // take: take first n elements, the whole list if n is larger than the length
+    template<typename L, length_t n> struct take;
+    template<typename... Ts, length_t n>
+    struct take<list<Ts...>, n>
     {
-        using type = wrapper_t<T, v1>;
+    private:
+        // Helper
+        template<typename S> struct helper;
+        template<length_t... is>
+        struct helper<std::integer_sequence<length_t, is...>>
+        {
+            using type = typename detail::join_tree<list<>, std::conditional_t<(is < n), list<Ts>, list<>>...>::type;
+        };
+
+    public:
+        using type = typename helper<detail::make_index_seq<sizeof...(Ts)>>::type;
     };
-    template<typename T, T v1, T... vs, length_t n>
-    struct get<list_c<T, v1, vs...>, n>
+    template<typename T, T... vs, length_t n>
+    struct take<list_c<T, vs...>, n>
     {
-        using type = typename get<list_c<T, vs...>, n - 1>::type;
+    private:
+        // Helper
+        template<typename S> struct helper;
+        template<length_t... is>
+        struct helper<std::integer_sequence<length_t, is...>>
+        {
+            using type = list_c<T, detail::values<T, vs...>::value[is]...>;
+        };
+
+    public:
+        using type = typename helper<detail::make_index_seq<(n < sizeof...(vs) ? n : sizeof...(vs))>>::type;
     };
     template<typename L, length_t n>
-    using get_t = typename get<L, n>::type;
+    using take_t = typename take<L, n>::type;
 
-    // set: set the nth item of a list
-    template<typename L, length_t n, typename T> struct set;
-    template<typename T1, typename... Ts, typename T>
-    struct set<list<T1, Ts...>, 0, T>
+    // drop: drop first n elements, an empty list if n is larger than the length
+    template<typename L, length_t n> struct drop;
+    template<typename... Ts, length_t n>
+    struct drop<list<Ts...>, n>
     {
-        using type = list<T, Ts...>;
+        using type = detail::drop_front_t<(n < sizeof...(Ts) ? n : sizeof...(Ts)), Ts...>;
     };
-    template<typename T1, typename... Ts, length_t n, typename T>
-    struct set<list<T1, Ts...>, n, T>
+    template<typename T, T... vs, length_t n>
+    struct drop<list_c<T, vs...>, n>
     {
-        using type = concat_t<list<T1>, typename set<list<Ts...>, n - 1, T>::type>;
+    private:
+        // Helper
+        static constexpr length_t m = n < sizeof...(vs) ? n : sizeof...(vs);
+        template<typename S> struct helper;
+        template<length_t... is>
+        struct helper<std::integer_sequence<length_t, is...>>
+        {
+            using type = list_c<T, detail::values<T, vs...>::value[m + is]...>;
+        };
+
+    public:
+        using type = typename helper<detail::make_index_seq<sizeof...(vs) - m>>::type;
     };
-    template<typename T, T v1, T... vs, T v>
-    struct set<list_c<T, v1, vs...>, 0, wrapper_t<T, v>>
+    template<typename L, length_t n>
+    using drop_t = typename drop<L, n>::type;
+
+    // set: set the nth item of a list
+    template<typename L, length_t n, typename T> struct set;
+    template<typename... Ts, length_t n, typename T>
+    struct set<list<Ts...>, n, T>
     {
-        using type = list_c<T, v, vs...>;
+        static_assert(n < sizeof...(Ts), "set: index out of range");
+        using type = concat_t<take_t<list<Ts...>, n>, concat_t<list<T>, drop_t<list<Ts...>, n + 1>>>;
     };
-    template<typename T, T v1, T... vs, length_t n, T v>
-    struct set<list_c<T, v1, vs...>, n, wrapper_t<T, v>>
+    template<typename T, T... vs, length_t n, T v>
+    struct set<list_c<T, vs...>, n, wrapper_t<T, v>>
     {
-        using type = concat_t<list_c<T, v1>, typename set<list_c<T, vs...>, n - 1, wrapper_t<T, v>>::type>;
+        static_assert(n < sizeof...(vs), "set: index out of range");
+        using type = concat_t<take_t<list_c<T, vs...>, n>, concat_t<list_c<T, v>, drop_t<list_c<T, vs...>, n + 1>>>;
     };
     template<typename L, length_t n, typename T>
     using set_t = typename set<L, n, T>::type;
 
     // insert: insert an item into list
     template<typename L, length_t n, typename T> struct insert;
-    template<typename... Ts, typename T>
-    struct insert<list<Ts...>, 0, T>
-    {
-        using type = list<T, Ts...>;
-    };
-    template<typename T1, typename... Ts, length_t n, typename T>
-    struct insert<list<T1, Ts...>, n, T>
-    {
-        using type = concat_t<list<T1>, typename insert<list<Ts...>, n - 1, T>::type>;
-    };
-    template<typename T, T... vs, T v>
-    struct insert<list_c<T, vs...>, 0, wrapper_t<T, v>>
+    template<typename... Ts, length_t n, typename T>
+    struct insert<list<Ts...>, n, T>
     {
-        using type = list_c<T, v, vs...>;
+        static_assert(n <= sizeof...(Ts), "insert: index out of range");
+        using type = concat_t<take_t<list<Ts...>, n>, concat_t<list<T>, drop_t<list<Ts...>, n>>>;
     };
-    template<typename T, T v1, T... vs, length_t n, T v>
-    struct insert<list_c<T, v1, vs...>, n, wrapper_t<T, v>>
+    template<typename T, T... vs, length_t n, T v>
+    struct insert<list_c<T, vs...>, n, wrapper_t<T, v>>
     {
-        using type = concat_t<list_c<T, v1>, typename insert<list_c<T, vs...>, n - 1, wrapper_t<T, v>>::type>;
+        static_assert(n <= sizeof...(vs), "insert: index out of range");
+        using type = concat_t<take_t<list_c<T, vs...>, n>, concat_t<list_c<T, v>, drop_t<list_c<T, vs...>, n>>>;
     };
     template<typename L, length_t n, typename T>
     using insert_t = typename insert<L, n, T>::type;
 
     // erase: erase an item from list
-    template<typename L, length_t n> struct erase;
-    template<typename T1, typename... Ts>
-    struct erase<list<T1, Ts...>, 0>
-    {
-        using type = list<Ts...>;
-    };
-    template<typename T1, typename... Ts, length_t n>
-    struct erase<list<T1, Ts...>, n>
-    {
-        using type = concat_t<list<T1>, typename erase<list<Ts...>, n - 1>::type>;
-    };
-    template<typename T, T v1, T... vs>
-    struct erase<list_c<T, v1, vs...>, 0>
-    {
-        using type = list_c<T, vs...>;
-    };
-    template<typename T, T v1, T... vs, length_t n>
-    struct erase<list_c<T, v1, vs...>, n>
+    template<typename L, length_t n>
+    struct erase
     {
-        using type = concat_t<list_c<T, v1>, typename erase<list_c<T, vs...>, n - 1>::type>;
+        static_assert(n < length_v<L>, "erase: index out of range");
+        using type = concat_t<take_t<L, n>, drop_t<L, n + 1>>;
     };
     template<typename L, length_t n>
     using erase_t = typename erase<L, n>::type;
 
     // find: find an item in list
     template<typename L, typename T> struct find;
-    template<typename T, typename... Ts>
-    struct find<list<T, Ts...>, T>
-    {
-        static constexpr length_t value = 0;
-    };
-    template<typename T1, typename... Ts, typename T>
-    struct find<list<T1, Ts...>, T>
-    {
-        static constexpr length_t value = 1 + find<list<Ts...>, T>::value;
-    };
-    template<typename T, T v, T... vs>
-    struct find<list_c<T, v, vs...>, wrapper_t<T, v>>
+    template<typename... Ts, typename T>
+    struct find<list<Ts...>, T>
     {
-        static constexpr length_t value = 0;
+        static constexpr length_t value = detail::index_of(detail::matches<T, Ts...>::value, true);
+        static_assert(value < sizeof...(Ts), "find: item not in list");
     };
-    template<typename T, T v1, T... vs, T v>
-    struct find<list_c<T, v1, vs...>, wrapper_t<T, v>>
+    template<typename T, T... vs, T v>
+    struct find<list_c<T, vs...>, wrapper_t<T, v>>
     {
-        static constexpr length_t value = 1 + find<list_c<T, vs...>, wrapper_t<T, v>>::value;
+        static constexpr length_t value = detail::index_of(detail::values<T, vs...>::value, v);
+        static_assert(value < sizeof...(vs), "find: item not in list");
     };
     template<typename L, typename T>
     constexpr length_t find_v = find<L, T>::value;
 
     // find_with_fail: find a item in list, return -1 when not find
     template<typename L, typename T> struct find_with_fail;
-    template<typename T>
-    struct find_with_fail<list<>, T>
-    {
-        static constexpr length_t value = -1;
-    };
-    template<typename T, typename... Ts>
-    struct find_with_fail<list<T, Ts...>, T>
-    {
-        static constexpr length_t value = 0;
-    };
-    template<typename T1, typename... Ts, typename T>
-    struct find_with_fail<list<T1, Ts...>, T>
+    template<typename... Ts, typename T>
+    struct find_with_fail<list<Ts...>, T>
     {
     private:
-        static constexpr length_t val = find_with_fail<list<Ts...>, T>::value;
+        static constexpr length_t val = detail::index_of(detail::matches<T, Ts...>::value, true);
     public:
-        static constexpr length_t value = (val == -1 ? -1 : (val + 1));
+        static constexpr length_t value = (val == sizeof...(Ts) ? -1 : val);
     };
-    template<typename T, T v, T... vs>
-    struct find_with_fail<list_c<T, v, vs...>, wrapper_t<T, v>>
-    {
-        static constexpr length_t value = 0;
-    };
-    template<typename T, T v1, T... vs, T v>
-    struct find_with_fail<list_c<T, v1, vs...>, wrapper_t<T, v>>
+    template<typename T, T... vs, T v>
+    struct find_with_fail<list_c<T, vs...>, wrapper_t<T, v>>
     {
     private:
-        static constexpr length_t val = find_with_fail<list_c<T, vs...>, wrapper_t<T, v>>::value;
+        static constexpr length_t val = detail::index_of(detail::values<T, vs...>::value, v);
     public:
-        static constexpr length_t value = (val == -1 ? -1 : (val + 1));
+        static constexpr length_t value = (val == sizeof...(vs) ? -1 : val);
     };
     template<typename L, typename T>
     constexpr length_t find_with_fail_v = find_with_fail<L, T>::value;
@@ -303,8 +832,8 @@ namespace ML
     {
         using type = concat_t<list<T1>, typename replace<list<Ts...>, T, U>::type>;
     };
-    template<typename T, typename U>
-    struct replace<list_c<T>, T, U>
+    template<typename T, T v, typename U>
+    struct replace<list_c<T>, wrapper_t<T, v>, U>
     {
         using type = list_c<T>;
     };
@@ -338,8 +867,8 @@ namespace ML
     {
         using type = concat_t<list<T1>, typename replace_all<list<Ts...>, T, U>::type>;
     };
-    template<typename T, typename U>
-    struct replace_all<list_c<T>, T, U>
+    template<typename T, T v, typename U>
+    struct replace_all<list_c<T>, wrapper_t<T, v>, U>
     {
         using type = list_c<T>;
     };
@@ -356,13 +885,43 @@ namespace ML
     template<typename L, typename T, typename U>
     using replace_all_t = typename replace_all<L, T, U>::type;
 
+    // range: generate list_c, the step may be negative
+    template<typename T, T l, T r, T d = 1>
+    struct range
+    {
+        static_assert(d != 0, "range: step must not be zero");
+
+    private:
+        // Helper
+        template<typename S> struct helper;
+        template<length_t... is>
+        struct helper<std::integer_sequence<length_t, is...>>
+        {
+            using type = list_c<T, detail::range_at<T>(l, d, is)...>;
+        };
+
+    public:
+        using type = typename helper<detail::make_index_seq<detail::range_size<T>(l, r, d)>>::type;
+    };
+    template<typename T, T l, T r, T d = 1>
+    using range_t = typename range<T, l, r, d>::type;
+
     // table: create a list with meta function
     template<template<auto> typename F, typename R> struct table;
     template<typename T, template<T> typename F, T l, T r, T d>
     struct table<F, range_c<T, l, r, d>>
     {
-        using type = conditional_t<bool_t<l <= r>,
-            concat_t<list<F<l>>, typename table<F, range_c<T, l + d, r, d>>::type>, list<>>;
+    private:
+        // Helper
+        template<typename L> struct helper;
+        template<T... vs>
+        struct helper<list_c<T, vs...>>
+        {
+            using type = list<F<vs>...>;
+        };
+
+    public:
+        using type = typename helper<range_t<T, l, r, d>>::type;
     };
     template<template<auto> typename F, typename R>
     using table_t = typename table<F, R>::type;
@@ -374,14 +933,6 @@ namespace ML
     template<template<auto> typename F, auto v, decltype(v) start = 1>
     using array_t = typename array<F, v, start>::type;
 
-    // range: generate list_c
-    template<typename T, T l, T r, T d = 1>
-    struct range
-    {
-        using type = conditional_t<bool_t<l <= r>,
-            concat_t<list_c<T, l>, typename range<T, l + d, r, d>::type>, list_c<T>>;
-    };
-
     // first, last: specified get
     template<typename L>
     struct first : public get<L, 0> {};
@@ -392,91 +943,6 @@ namespace ML
     template<typename L>
     using last_t = typename last<L>::type;
 
-    // take: take first n elements
-    template<typename L, length_t n> struct take;
-    template<>
-    struct take<list<>, 0>
-    {
-        using type = list<>;
-    };
-    template<length_t n>
-    struct take<list<>, n>
-    {
-        using type = list<>;
-    };
-    template<typename... Ts>
-    struct take<list<Ts...>, 0>
-    {
-        using type = list<>;
-    };
-    template<typename T1, typename... Ts, length_t n>
-    struct take<list<T1, Ts...>, n>
-    {
-        using type = concat_t<list<T1>, typename take<list<Ts...>, n - 1>::type>;
-    };
-    template<typename T>
-    struct take<list_c<T>, 0>
-    {
-        using type = list_c<T>;
-    };
-    template<typename T, length_t n>
-    struct take<list_c<T>, n>
-    {
-        using type = list_c<T>;
-    };
-    template<typename T, T... vs>
-    struct take<list_c<T, vs...>, 0>
-    {
-        using type = list_c<T>;
-    };
-    template<typename T, T v1, T... vs, length_t n>
-    struct take<list_c<T, v1, vs...>, n>
-    {
-        using type = concat_t<list_c<T, v1>, typename take<list_c<T, vs...>, n - 1>::type>;
-    };
-    template<typename L, length_t n>
-    using take_t = typename take<L, n>::type;
-
-    // drop: drop first n elements
-    template<typename L, length_t n> struct drop;
-    template<>
-    struct drop<list<>, 0>
-    {
-        using type = list<>;
-    };
-    template<length_t n>
-    struct drop<list<>, n>
-    {
-        using type = list<>;
-    };
-    template<typename L>
-    struct drop<L, 0>
-    {
-        using type = L;
-    };
-    template<typename T1, typename... Ts, length_t n>
-    struct drop<list<T1, Ts...>, n>
-    {
-        using type = typename drop<list<Ts...>, n - 1>::type;
-    };
-    template<typename T>
-    struct drop<list_c<T>, 0>
-    {
-        using type = list_c<T>;
-    };
-    template<typename T, length_t n>
-    struct drop<list_c<T>, n>
-    {
-        using type = list_c<T>;
-    };
-    template<typename T, T v1, T... vs, length_t n>
-    struct drop<list_c<T, v1, vs...>, n>
-    {
-        using type = typename drop<list_c<T, vs...>, n - 1>::type;
-    };
-    template<typename L, length_t n>
-    using drop_t = typename drop<L, n>::type;
-
     // extract: extract several parts
     template<typename L, typename IL>
     struct extract
@@ -494,154 +960,197 @@ namespace ML
 
     // select: select some element from the list
     template<typename L, template<typename> typename F> struct select;
-    template<template<typename> typename F>
-    struct select<list<>, F>
-    {
-        using type = list<>;
-    };
-    template<typename T1, typename... Ts, template<typename> typename F>
-    struct select<list<T1, Ts...>, F>
-    {
-        using type = concat_t<conditional_t<F<T1>, list<T1>, list<>>,
-            typename select<list<Ts...>, F>::type>;
-    };
-    template<typename T, template<typename> typename F>
-    struct select<list_c<T>, F>
+    template<typename... Ts, template<typename> typename F>
+    struct select<list<Ts...>, F>
     {
-        using type = list_c<T>;
+        using type = typename detail::join_tree<list<>,
+            conditional_t<F<Ts>, list<Ts>, list<>>...>::type;
     };
-    template<typename T, T v1, T... vs, template<typename> typename F>
-    struct select<list_c<T, v1, vs...>, F>
+    template<typename T, T... vs, template<typename> typename F>
+    struct select<list_c<T, vs...>, F>
     {
-        using type = concat_t<conditional_t<F<wrapper_t<T, v1>>, list_c<T, v1>, list_c<T>>,
-            typename select<list_c<T, vs...>, F>::type>;
+        using type = typename detail::join_tree<list_c<T>,
+            conditional_t<F<wrapper_t<T, vs>>, list_c<T, vs>, list_c<T>>...>::type;
     };
     template<typename L, template<typename> typename F>
     using select_t = typename select<L, F>::type;
 
     // count: the number of specified item
     template<typename L, typename T> struct count;
-    template<typename T>
-    struct count<list<>, T>
-    {
-        static constexpr length_t value = 0;
-    };
-    template<typename T, typename... Ts>
-    struct count<list<T, Ts...>, T>
-    {
-        static constexpr length_t value = 1 + count<list<Ts...>, T>::value;
-    };
-    template<typename T1, typename... Ts, typename T>
-    struct count<list<T1, Ts...>, T>
-    {
-        static constexpr length_t value = count<list<Ts...>, T>::value;
-    };
-    template<typename T, T v>
-    struct count<list_c<T>, wrapper_t<T, v>>
-    {
-        static constexpr length_t value = 0;
-    };
-    template<typename T, T v, T... vs>
-    struct count<list_c<T, v, vs...>, wrapper_t<T, v>>
+    template<typename... Ts, typename T>
+    struct count<list<Ts...>, T>
     {
-        static constexpr length_t value = 1 + count<list_c<T, vs...>, wrapper_t<T, v>>::value;
+        static constexpr length_t value = detail::count_of(detail::matches<T, Ts...>::value, true);
     };
-    template<typename T, T v1, T... vs, T v>
-    struct count<list_c<T, v1, vs...>, wrapper_t<T, v>>
+    template<typename T, T... vs, T v>
+    struct count<list_c<T, vs...>, wrapper_t<T, v>>
     {
-        static constexpr length_t value = count<list_c<T, vs...>, wrapper_t<T, v>>::value;
+        static constexpr length_t value = detail::count_of(detail::values<T, vs...>::value, v);
     };
     template<typename L, typename T>
     constexpr length_t count_v = count<L, T>::value;
 
-    // member: determine if an item is in a list
-    template<typename L, typename T>
-    struct member : public bool_t<(find_with_fail_v<L, T> >= 0)>
+    // member: determine if an item is in a list, stops at the first match
+    template<typename L, typename T> struct member;
+    template<typename... Ts, typename T>
+    struct member<list<Ts...>, T> : public bool_t<(std::is_same_v<T, Ts> || ...)>
+    {};
+    template<typename T, T... vs, T v>
+    struct member<list_c<T, vs...>, wrapper_t<T, v>> : public bool_t<((vs == v) || ...)>
     {};
     template<typename L, typename T>
     constexpr bool member_v = member<L, T>::value;
 
-    // sort: using quick sort to sort the list
-    template<typename L> struct sort;
-    template<typename T>
-    struct sort<list_c<T>>
+    // sort: sort a list_c with heap sort on a constexpr array, C compares two values
+    template<typename L, typename C = less> struct sort;
+    template<typename T, T... vs, typename C>
+    struct sort<list_c<T, vs...>, C>
     {
-        using type = list_c<T>;
+    private:
+        // Helper
+        struct sorted
+        {
+            static constexpr auto value = detail::heap_sort(detail::values<T, vs...>::value, C{});
+        };
+
+    public:
+        using type = typename detail::array_list_c<T, sorted>::type;
     };
-    template<typename T, T v>
-    struct sort<list_c<T, v>>
+    template<typename L, typename C = less>
+    using sort_t = typename sort<L, C>::type;
+
+    // stable_sort: sort a list_c with merge sort, equivalent values keep their order
+    template<typename L, typename C = less> struct stable_sort;
+    template<typename T, T... vs, typename C>
+    struct stable_sort<list_c<T, vs...>, C>
     {
-        using type = list_c<T, v>;
+    private:
+        // Helper
+        struct sorted
+        {
+            static constexpr auto value = detail::merge_sort(detail::values<T, vs...>::value, C{});
+        };
+
+    public:
+        using type = typename detail::array_list_c<T, sorted>::type;
     };
-    template<typename T, T v1, T... vs>
-    struct sort<list_c<T, v1, vs...>>
+    template<typename L, typename C = less>
+    using stable_sort_t = typename stable_sort<L, C>::type;
+
+    // sort_by: stable sort a list by K<T>::value, list_c items are passed to K as wrapper_t
+    template<typename L, template<typename> typename K, typename C = less> struct sort_by;
+    template<template<typename> typename K, typename C>
+    struct sort_by<list<>, K, C>
+    {
+        using type = list<>;
+    };
+    template<typename T, typename... Ts, template<typename> typename K, typename C>
+    struct sort_by<list<T, Ts...>, K, C>
+    {
+    private:
+        // Helpers, keys are converted to the key type of the first item
+        using key_t = std::decay_t<decltype(K<T>::value)>;
+        static constexpr std::array<key_t, sizeof...(Ts) + 1> keys{{K<T>::value, K<Ts>::value...}};
+        template<typename S> struct helper;
+        template<length_t... is>
+        struct helper<std::integer_sequence<length_t, is...>>
+        {
+            static constexpr auto value = detail::sort_order(keys, C{});
+            using type = list<detail::type_at_t<value[is], T, Ts...>...>;
+        };
+
+    public:
+        using type = typename helper<detail::make_index_seq<sizeof...(Ts) + 1>>::type;
+    };
+    template<typename T, template<typename> typename K, typename C>
+    struct sort_by<list_c<T>, K, C>
+    {
+        using type = list_c<T>;
+    };
+    template<typename T, T v, T... vs, template<typename> typename K, typename C>
+    struct sort_by<list_c<T, v, vs...>, K, C>
     {
     private:
         // Helpers
-        template<typename V>
-        using lt = bool_t<(V::value < v1)>;
-        template<typename V>
-        using eq = bool_t<(V::value == v1)>;
-        template<typename V>
-        using gt = bool_t<(V::value > v1)>;
+        using key_t = std::decay_t<decltype(K<wrapper_t<T, v>>::value)>;
+        static constexpr std::array<key_t, sizeof...(vs) + 1> keys{{K<wrapper_t<T, v>>::value,
+            K<wrapper_t<T, vs>>::value...}};
+        struct sorted
+        {
+            static constexpr auto value = detail::permute(detail::values<T, v, vs...>::value,
+                detail::sort_order(keys, C{}));
+        };
 
+    public:
+        using type = typename detail::array_list_c<T, sorted>::type;
+    };
+    template<typename L, template<typename> typename K, typename C = less>
+    using sort_by_t = typename sort_by<L, K, C>::type;
+
+    // unique: delete successive duplicates (need the list to be sorted), in one pass
+    template<typename L> struct unique;
+    template<typename... Ts>
+    struct unique<list<Ts...>>
+    {
+        using type = typename detail::unique_pairs<list<detail::pair_end, Ts...>,
+            list<Ts..., detail::pair_end>>::type;
+    };
+    template<typename T, T... vs>
+    struct unique<list_c<T, vs...>>
+    {
     private:
-        // 3 Parts
-        using rest = list_c<T, vs...>;
-        using lower = typename sort<select_t<rest, lt>>::type;
-        using equal = select_t<rest, eq>; // no need to sort
-        using great = typename sort<select_t<rest, gt>>::type;
+        // Helper
+        struct keep
+        {
+            static constexpr auto value = detail::run_starts(detail::values<T, vs...>::value);
+        };
 
     public:
-        using type = join_t<lower, list_c<T, v1>, equal, great>;
+        using type = typename detail::kept_values<keep, T, vs...>::type;
     };
     template<typename L>
-    using sort_t = typename sort<L>::type;
+    using unique_t = typename unique<L>::type;
 
-    // unique: delete successive duplicates (need the list to be sorted)
-    template<typename L> struct unique;
+    // distinct: keep the first occurrence of every item, the list need not be sorted
+    // The second half of a list keeps the items not in the type_set of the first one
+    template<typename L> struct distinct;
     template<>
-    struct unique<list<>>
+    struct distinct<list<>>
     {
         using type = list<>;
     };
     template<typename T>
-    struct unique<list<T>>
+    struct distinct<list<T>>
     {
         using type = list<T>;
     };
-    template<typename T1, typename... Ts>
-    struct unique<list<T1, T1, Ts...>>
-    {
-        using type = typename unique<list<T1, Ts...>>::type;
-    };
     template<typename T1, typename T2, typename... Ts>
-    struct unique<list<T1, T2, Ts...>>
-    {
-        using type = concat_t<list<T1>, typename unique<list<T2, Ts...>>::type>;
-    };
-    template<typename T>
-    struct unique<list_c<T>>
+    struct distinct<list<T1, T2, Ts...>>
     {
-        using type = list_c<T>;
-    };
-    template<typename T, T v>
-    struct unique<list_c<T, v>>
-    {
-        using type = list_c<T, v>;
-    };
-    template<typename T, T v1, T... vs>
-    struct unique<list_c<T, v1, v1, vs...>>
-    {
-        using type = typename unique<list_c<T, v1, vs...>>::type;
+    private:
+        // Helpers
+        static constexpr length_t half = (sizeof...(Ts) + 2) / 2;
+        using front = typename distinct<take_t<list<T1, T2, Ts...>, half>>::type;
+        using back = typename distinct<drop_t<list<T1, T2, Ts...>, half>>::type;
+
+    public:
+        using type = join_t<front, typename detail::select_new<detail::type_set<front>, back>::type>;
     };
-    template<typename T, T v1, T v2, T... vs>
-    struct unique<list_c<T, v1, v2, vs...>>
+    template<typename T, T... vs>
+    struct distinct<list_c<T, vs...>>
     {
-        using type = concat_t<list_c<T, v1>, typename unique<list_c<T, v2, vs...>>::type>;
+    private:
+        // Helper
+        struct keep
+        {
+            static constexpr auto value = detail::first_occurrences(detail::values<T, vs...>::value);
+        };
+
+    public:
+        using type = typename detail::kept_values<keep, T, vs...>::type;
     };
     template<typename L>
-    using unique_t = typename unique<L>::type;
+    using distinct_t = typename distinct<L>::type;
 
     // flatten: make a list flat
     template<typename L, length_t n = static_cast<length_t>(-1)> struct flatten;
@@ -759,31 +1268,75 @@ namespace ML
     template<template<typename...> typename F, typename... Ls>
     using thread_t = typename thread<F, Ls...>::type;
 
-    // fold: left-fold the list
-    template<template<typename, typename> typename F, typename S, typename L> struct fold;
-    template<template<typename, typename> typename F, typename S>
-    struct fold<F, S, list<>>
-    {
-        using type = S;
-    };
-    template<template<typename, typename> typename F, typename S, typename T1, typename... Ts>
-    struct fold<F, S, list<T1, Ts...>>
+    // fold_left: left-fold the list, F<...F<F<S, T1>, T2>..., Tn>
+    template<template<typename, typename> typename F, typename S, typename L> struct fold_left;
+    template<template<typename, typename> typename F, typename S, typename... Ts>
+    struct fold_left<F, S, list<Ts...>>
     {
-        using type = F<S, typename fold<F, T1, list<Ts...>>::type>;
+        using type = typename decltype((detail::fold_left_acc<F, detail::box<S>>{} + ... +
+            detail::fold_item<Ts>{}))::type;
     };
-    template<template<typename, typename> typename F, typename S, typename T>
-    struct fold<F, S, list_c<T>>
-    {
-        using type = S;
-    };
-    template<template<typename, typename> typename F, typename S, typename T, T v1, T... vs>
-    struct fold<F, S, list_c<T, v1, vs...>>
+    template<template<typename, typename> typename F, typename S, typename T, T... vs>
+    struct fold_left<F, S, list_c<T, vs...>> : public fold_left<F, S, list<wrapper_t<T, vs>...>>
+    {};
+    template<template<typename, typename> typename F, typename S, typename L>
+    using fold_left_t = typename fold_left<F, S, L>::type;
+
+    // fold_right: right-fold the list, F<T1, F<T2, ...F<Tn, S>...>>
+    template<template<typename, typename> typename F, typename S, typename L> struct fold_right;
+    template<template<typename, typename> typename F, typename S, typename... Ts>
+    struct fold_right<F, S, list<Ts...>>
     {
-        using type = F<S, typename fold<F, wrapper_t<T, v1>, list_c<T, vs...>>::type>;
+        using type = typename decltype((detail::fold_item<Ts>{} + ... +
+            detail::fold_right_acc<F, detail::box<S>>{}))::type;
     };
+    template<template<typename, typename> typename F, typename S, typename T, T... vs>
+    struct fold_right<F, S, list_c<T, vs...>> : public fold_right<F, S, list<wrapper_t<T, vs>...>>
+    {};
+    template<template<typename, typename> typename F, typename S, typename L>
+    using fold_right_t = typename fold_right<F, S, L>::type;
+
+    // fold: left-fold the list, same as fold_left
+    template<template<typename, typename> typename F, typename S, typename L>
+    struct fold : public fold_left<F, S, L>
+    {};
     template<template<typename, typename> typename F, typename S, typename L>
     using fold_t = typename fold<F, S, L>::type;
 
+    // sum, bit_xor, minimum, maximum: reduce the values of a list_c by one fold expression
+    template<typename L> struct sum;
+    template<typename T, T... vs>
+    struct sum<list_c<T, vs...>> : public wrapper_t<T, static_cast<T>((T{} + ... + vs))>
+    {};
+    template<typename L>
+    constexpr auto sum_v = sum<L>::value;
+    template<typename L> struct bit_xor;
+    template<typename T, T... vs>
+    struct bit_xor<list_c<T, vs...>> : public wrapper_t<T, static_cast<T>((T{} ^ ... ^ vs))>
+    {};
+    template<typename L>
+    constexpr auto bit_xor_v = bit_xor<L>::value;
+    template<typename L> struct minimum;
+    template<typename T, T v1, T... vs>
+    struct minimum<list_c<T, v1, vs...>> : public wrapper_t<T, (detail::min_acc<T>{v1} | ... | detail::min_acc<T>{vs}).value>
+    {};
+    template<typename L>
+    constexpr auto minimum_v = minimum<L>::value;
+    template<typename L> struct maximum;
+    template<typename T, T v1, T... vs>
+    struct maximum<list_c<T, v1, vs...>> : public wrapper_t<T, (detail::max_acc<T>{v1} | ... | detail::max_acc<T>{vs}).value>
+    {};
+    template<typename L>
+    constexpr auto maximum_v = maximum<L>::value;
+
+    // fold_values: left-fold the values of a list_c from init with a constexpr function object,
+    // f(...f(f(init, v1), v2)..., vn)
+    template<typename L, typename S, typename Fn>
+    constexpr S fold_values(S init, Fn f)
+    {
+        return detail::value_fold<L>::apply(init, f);
+    }
+
     // difference: different function
     template<template<typename, typename> typename F, typename L> struct difference;
     template<template<typename, typename> typename F>
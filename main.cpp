@@ -1,8 +1,74 @@
 #include <iostream>
 #include "list.hpp"
+#include "runtime.hpp"
+
+// get
+static_assert(std::is_same_v<ML::get_t<ML::list<int, char, int>, 0>, int>);
+static_assert(std::is_same_v<ML::get_t<ML::list<int, char, int>, 1>, char>);
+static_assert(std::is_same_v<ML::get_t<ML::list<int, char, int>, 2>, int>);
+static_assert(std::is_same_v<ML::get_t<ML::list<int, int, int>, 2>, int>);
+static_assert(std::is_same_v<ML::get_t<ML::int_list<3, 1, 3>, 2>, ML::int_t<3>>);
+static_assert(std::is_same_v<ML::get_t<ML::char_list<'a'>, 0>, ML::char_t<'a'>>);
+
+// range, table and array
+template<int i> using square = ML::int_t<i * i>;
+static_assert(std::is_same_v<ML::range_t<int, 0, 3>, ML::int_list<0, 1, 2, 3>>);
+static_assert(std::is_same_v<ML::range_t<int, 0, 7, 3>, ML::int_list<0, 3, 6>>);
+static_assert(std::is_same_v<ML::range_t<int, 3, -3, -2>, ML::int_list<3, 1, -1, -3>>);
+static_assert(std::is_same_v<ML::range_t<int, 1, 0>, ML::int_list<>>);
+static_assert(std::is_same_v<ML::range_t<int, 0, 1, -1>, ML::int_list<>>);
+static_assert(std::is_same_v<ML::table_t<square, ML::int_range<2, -2, -2>>,
+    ML::list<ML::int_t<4>, ML::int_t<0>, ML::int_t<4>>>);
+static_assert(std::is_same_v<ML::table_t<square, ML::int_range<1, 0>>, ML::list<>>);
+static_assert(std::is_same_v<ML::array_t<square, 3>, ML::list<ML::int_t<1>, ML::int_t<4>, ML::int_t<9>>>);
+static_assert(std::is_same_v<ML::array_t<square, 1, 0>, ML::list<ML::int_t<0>, ML::int_t<1>>>);
+
+// select
+template<typename T> using odd = ML::bool_t<T::value % 2 != 0>;
+template<typename T> using not_int = ML::bool_t<!std::is_same_v<T, int>>;
+static_assert(std::is_same_v<ML::select_t<ML::list<int, char, int, long>, not_int>, ML::list<char, long>>);
+static_assert(std::is_same_v<ML::select_t<ML::list<int, int>, not_int>, ML::list<>>);
+static_assert(std::is_same_v<ML::select_t<ML::list<>, not_int>, ML::list<>>);
+static_assert(std::is_same_v<ML::select_t<ML::range_t<int, -3, 12>, odd>,
+    ML::int_list<-3, -1, 1, 3, 5, 7, 9, 11>>);
+static_assert(std::is_same_v<ML::select_t<ML::int_list<2, 4>, odd>, ML::int_list<>>);
+
+// join
+static_assert(std::is_same_v<ML::join_t<ML::list<int>, ML::list<>, ML::list<char, int>>, ML::list<int, char, int>>);
+static_assert(std::is_same_v<ML::join_t<ML::int_list<1>, ML::list<ML::int_t<2>>, ML::int_list<3, 4>>,
+    ML::int_list<1, 2, 3, 4>>);
+static_assert(std::is_same_v<ML::join_t<ML::list<ML::int_t<0>>, ML::int_list<1>, ML::list<>>, ML::int_list<0, 1>>);
+
+// fold and value folds
+template<typename A, typename B> struct pair {};
+template<typename A, typename B> using minus = ML::int_t<A::value - B::value>;
+static_assert(std::is_same_v<ML::fold_t<pair, void, ML::list<int, char>>, pair<pair<void, int>, char>>);
+static_assert(std::is_same_v<ML::fold_right_t<pair, void, ML::list<int, char>>, pair<int, pair<char, void>>>);
+static_assert(std::is_same_v<ML::fold_left_t<pair, void, ML::list<>>, void>);
+static_assert(ML::fold_left_t<minus, ML::int_t<10>, ML::int_list<1, 2, 3>>::value == 4);
+static_assert(ML::fold_right_t<minus, ML::int_t<0>, ML::int_list<1, 2, 3>>::value == 2);
+static_assert(ML::sum_v<ML::int_list<1, 2, 3>> == 6 && ML::sum_v<ML::int_list<>> == 0);
+static_assert(ML::bit_xor_v<ML::int_list<5, 3>> == 6);
+static_assert(ML::minimum_v<ML::int_list<4, -2, 9>> == -2 && ML::maximum_v<ML::int_list<4, -2, 9>> == 9);
+static_assert(ML::fold_values<ML::int_list<1, 2, 3>>(0, [](int a, int b) {return a * 10 + b;}) == 123);
+
+// to_array, dispatch_table, perfect_hash
+template<typename T> struct size_of
+{
+    static constexpr std::size_t invoke() {return sizeof(T);}
+};
+static_assert(ML::to_array_v<ML::int_list<3, 1, 2>>[0] == 3 && ML::to_array_v<ML::int_list<3, 1, 2>>[2] == 2);
+static_assert(&ML::to_array_v<ML::int_list<3>> == &ML::to_array_v<ML::list<ML::int_t<3>>>);
+static_assert(ML::to_array_v<ML::int_list<>>.empty());
+static_assert(ML::dispatch_table_v<ML::list<char, int[4]>, size_of>[1]() == sizeof(int[4]));
+static_assert(ML::perfect_hash<ML::char_list<'+', '-', '*', '/'>>::dense && ML::hash_find<ML::char_list<'+', '-', '*', '/'>>('/') == 3);
+static_assert(!ML::perfect_hash<ML::int_list<-7, 1 << 20, 42, 1 << 20>>::dense);
+static_assert(ML::hash_find<ML::int_list<-7, 1 << 20, 42, 1 << 20>>(1 << 20) == 1 && ML::hash_find<ML::int_list<-7, 1 << 20, 42, 1 << 20>>(-7) == 0);
+static_assert(ML::hash_find<ML::int_list<-7, 1 << 20, 42, 1 << 20>>(43) == ML::length_t(-1));
+static_assert(ML::hash_find<ML::int_list<>>(0) == ML::length_t(-1));
 
 int main()
 {
     std::cout << "Hello, World!" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,305 @@
+//
+// Bridges from lists to runtime code: constexpr storage and dispatch tables
+//
+
+#ifndef MLIST_RUNTIME_HPP
+#define MLIST_RUNTIME_HPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "list.hpp"
+
+namespace ML
+{
+    // type_tag: an empty object standing for the type T, whatever T is
+    template<typename T>
+    struct type_tag
+    {
+        using type = T;
+    };
+
+    namespace detail
+    {
+        // array_of: the values of a list_c, or of a list of wrapper_t, as a std::array
+        template<typename T>
+        struct array_of
+        {
+            template<T... vs>
+            struct values
+            {
+                static constexpr std::array<T, sizeof...(vs)> value{{vs...}};
+            };
+        };
+
+        // invoke_table: F<T>::invoke for every T, all with the signature of the first one
+        template<template<typename> typename F>
+        struct invoke_table
+        {
+            template<typename T1, typename... Ts>
+            struct of
+            {
+                using fn_t = decltype(&F<T1>::invoke);
+                static_assert((std::is_same_v<decltype(&F<Ts>::invoke), fn_t> && ...),
+                    "dispatch_table: every F<T>::invoke must have the same signature");
+                static constexpr std::array<fn_t, sizeof...(Ts) + 1> value{{&F<T1>::invoke, &F<Ts>::invoke...}};
+            };
+        };
+
+        // visit_table: calls of Fn with type_tag<T> for every T, all with the same return type
+        template<typename Fn>
+        struct visit_table
+        {
+            template<typename T1, typename... Ts>
+            struct of
+            {
+                using result_t = std::invoke_result_t<Fn, type_tag<T1>>;
+                static_assert((std::is_same_v<std::invoke_result_t<Fn, type_tag<Ts>>, result_t> && ...),
+                    "visit_at: f must return the same type for every item");
+                template<typename T>
+                static result_t call(Fn&& f)
+                {
+                    return std::forward<Fn>(f)(type_tag<T>{});
+                }
+                static constexpr std::array<result_t (*)(Fn&&), sizeof...(Ts) + 1> value{{&call<T1>, &call<Ts>...}};
+            };
+        };
+
+        // hash_key: the bits of an integral or enumeration value
+        template<typename T>
+        constexpr std::uint64_t hash_key(T v)
+        {
+            if constexpr (std::is_enum_v<T>) return static_cast<std::uint64_t>(static_cast<std::underlying_type_t<T>>(v));
+            else return static_cast<std::uint64_t>(v);
+        }
+
+        // hash_mix: mix a key with a seed so that every bit depends on all of them
+        constexpr std::uint64_t hash_mix(std::uint64_t x, std::uint64_t seed)
+        {
+            x ^= seed;
+            x *= 0x9E3779B97F4A7C15ull;
+            x ^= x >> 29;
+            x *= 0xBF58476D1CE4E5B9ull;
+            return x ^ (x >> 32);
+        }
+
+        // hash_pow2: the smallest power of two not less than n
+        constexpr length_t hash_pow2(length_t n)
+        {
+            length_t r = 1;
+            while (r < n) r *= 2;
+            return r;
+        }
+
+        // hash_low, hash_span: the key of the smallest value and the distance to the largest one
+        template<typename T, std::size_t n>
+        constexpr std::uint64_t hash_low(const std::array<T, n>& vs)
+        {
+            T low = n == 0 ? T{} : vs[0];
+            for (length_t i = 1; i < n; ++i) if (vs[i] < low) low = vs[i];
+            return hash_key(low);
+        }
+        template<typename T, std::size_t n>
+        constexpr std::uint64_t hash_span(const std::array<T, n>& vs)
+        {
+            T high = n == 0 ? T{} : vs[0];
+            for (length_t i = 1; i < n; ++i) if (high < vs[i]) high = vs[i];
+            return hash_key(high) - hash_low(vs);
+        }
+
+        // dense_table: a slot for every value in [low, low + span), holding its first index
+        template<typename T, std::size_t n, length_t span>
+        struct dense_table
+        {
+            std::uint64_t low = 0;
+            std::array<length_t, span> index{};
+
+            constexpr length_t find(T v) const
+            {
+                const std::uint64_t offset = hash_key(v) - low;
+                return offset < span ? index[offset] : static_cast<length_t>(-1);
+            }
+        };
+        template<typename T, std::size_t n, length_t span>
+        constexpr dense_table<T, n, span> make_dense_table(const std::array<T, n>& vs, std::uint64_t low)
+        {
+            dense_table<T, n, span> table{};
+            table.low = low;
+            for (length_t i = 0; i < span; ++i) table.index[i] = static_cast<length_t>(-1);
+            for (length_t i = n; i > 0; --i) table.index[hash_key(vs[i - 1]) - low] = i - 1;
+            return table;
+        }
+
+        // hash_table: hash and displace, the keys are split into buckets by one hash, then
+        // every bucket, largest first, gets the first seed that puts its keys in free slots
+        template<typename T, std::size_t n>
+        struct hash_table
+        {
+            static constexpr length_t slots = hash_pow2(n), buckets = hash_pow2((n + 3) / 4);
+            std::array<std::uint64_t, buckets> seeds{};
+            std::array<T, slots> keys{};
+            std::array<length_t, slots> index{};
+
+            constexpr length_t find(T v) const
+            {
+                const std::uint64_t key = hash_key(v);
+                const length_t slot = hash_mix(key, seeds[hash_mix(key, 0) & (buckets - 1)]) & (slots - 1);
+                return keys[slot] == v ? index[slot] : static_cast<length_t>(-1);
+            }
+        };
+        template<typename T, std::size_t n>
+        constexpr hash_table<T, n> make_hash_table(const std::array<T, n>& vs)
+        {
+            using table_t = hash_table<T, n>;
+            constexpr length_t slots = table_t::slots, buckets = table_t::buckets;
+            table_t table{};
+            for (length_t i = 0; i < slots; ++i) table.index[i] = static_cast<length_t>(-1);
+
+            // Chain the keys of every bucket, a repeated value keeps its first index
+            std::array<length_t, buckets> head{}, size{};
+            std::array<length_t, n> next{};
+            length_t largest = 0;
+            for (length_t b = 0; b < buckets; ++b) head[b] = n;
+            for (length_t i = 0; i < n; ++i)
+            {
+                const length_t b = hash_mix(hash_key(vs[i]), 0) & (buckets - 1);
+                bool repeated = false;
+                for (length_t j = head[b]; j != n; j = next[j]) repeated = repeated || vs[j] == vs[i];
+                if (repeated) continue;
+                next[i] = head[b];
+                head[b] = i;
+                if (++size[b] > largest) largest = size[b];
+            }
+
+            // Place the buckets from the largest one down
+            std::array<length_t, n> chosen{};
+            for (length_t k = largest; k > 0; --k)
+            {
+                for (length_t b = 0; b < buckets; ++b)
+                {
+                    if (size[b] != k) continue;
+                    for (std::uint64_t seed = 1;; ++seed)
+                    {
+                        length_t m = 0;
+                        bool fits = true;
+                        for (length_t j = head[b]; fits && j != n; j = next[j])
+                        {
+                            const length_t slot = hash_mix(hash_key(vs[j]), seed) & (slots - 1);
+                            fits = table.index[slot] == static_cast<length_t>(-1);
+                            for (length_t c = 0; fits && c < m; ++c) fits = chosen[c] != slot;
+                            chosen[m++] = slot;
+                        }
+                        if (!fits) continue;
+                        m = 0;
+                        for (length_t j = head[b]; j != n; j = next[j])
+                        {
+                            table.keys[chosen[m]] = vs[j];
+                            table.index[chosen[m++]] = j;
+                        }
+                        table.seeds[b] = seed;
+                        break;
+                    }
+                }
+            }
+            return table;
+        }
+
+        // make_lookup: the dense table when the values span at most 2n + 16 keys, the hash table otherwise
+        template<bool dense, length_t span, typename T, std::size_t n>
+        constexpr auto make_lookup(const std::array<T, n>& vs)
+        {
+            if constexpr (dense) return make_dense_table<T, n, span>(vs, hash_low(vs));
+            else return make_hash_table(vs);
+        }
+    } // namespace detail
+
+    // to_array: the values of a list_c (or a list of wrapper_t) in static constexpr storage
+    template<typename L> struct to_array;
+    template<typename T, T... vs>
+    struct to_array<list_c<T, vs...>>
+    {
+        using type = std::array<T, sizeof...(vs)>;
+        static constexpr const type& value = list_c<T, vs...>::template rebind<
+            detail::array_of<T>::template values>::value;
+    };
+    template<typename T, T... vs>
+    struct to_array<list<wrapper_t<T, vs>...>> : public to_array<list_c<T, vs...>>
+    {};
+    template<typename L>
+    constexpr const auto& to_array_v = to_array<L>::value;
+
+    // perfect_hash: runtime position of a value in a list_c (or a list of wrapper_t), -1 when it is
+    // absent like find_with_fail, in O(1) without a search: a table indexed by the value if the values
+    // are dense, otherwise a collision free hash built at compile time and checked by one comparison
+    template<typename L> struct perfect_hash;
+    template<typename T, T... vs>
+    struct perfect_hash<list_c<T, vs...>>
+    {
+        static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "perfect_hash: values must be integral or enumerations");
+
+    private:
+        // Helpers
+        static constexpr const auto& values = to_array_v<list_c<T, vs...>>;
+        static constexpr std::uint64_t span = detail::hash_span(values);
+
+    public:
+        using value_type = T;
+        static constexpr bool dense = span < 2 * sizeof...(vs) + 16;
+
+    private:
+        static constexpr auto table = detail::make_lookup<dense, dense ? span + 1 : 0>(values);
+
+    public:
+        static constexpr length_t find(T v)
+        {
+            return table.find(v);
+        }
+    };
+    template<typename T, T... vs>
+    struct perfect_hash<list<wrapper_t<T, vs>...>> : public perfect_hash<list_c<T, vs...>>
+    {};
+
+    // hash_find: the position of v in L at runtime, see perfect_hash
+    template<typename L>
+    constexpr length_t hash_find(typename perfect_hash<L>::value_type v)
+    {
+        return perfect_hash<L>::find(v);
+    }
+
+    // dispatch_table: pointers to F<T>::invoke for every item of a list, list_c items are wrapper_t
+    template<typename L, template<typename> typename F>
+    struct dispatch_table
+    {
+    private:
+        // Helper
+        using table = typename detail::as_list<L>::type::template rebind<detail::invoke_table<F>::template of>;
+
+    public:
+        static_assert(length_v<L> != 0, "dispatch_table: list must not be empty");
+        static constexpr const auto& value = table::value;
+    };
+    template<typename L, template<typename> typename F>
+    constexpr const auto& dispatch_table_v = dispatch_table<L, F>::value;
+
+    // dispatch: call F<get_t<L, i>>::invoke(args...) for a runtime index i < length_v<L>
+    template<typename L, template<typename> typename F, typename... Args>
+    decltype(auto) dispatch(length_t i, Args&&... args)
+    {
+        assert(i < length_v<L>);
+        return dispatch_table_v<L, F>[i](std::forward<Args>(args)...);
+    }
+
+    // visit_at: call f(type_tag<get_t<L, i>>{}) for a runtime index i < length_v<L>
+    template<typename L, typename Fn>
+    decltype(auto) visit_at(length_t i, Fn&& f)
+    {
+        static_assert(length_v<L> != 0, "visit_at: list must not be empty");
+        using table = typename detail::as_list<L>::type::template rebind<detail::visit_table<Fn>::template of>;
+        assert(i < length_v<L>);
+        return table::value[i](std::forward<Fn>(f));
+    }
+} // namespace ML
+
+#endif //MLIST_RUNTIME_HPP